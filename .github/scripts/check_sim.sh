@@ -7,10 +7,24 @@
 
 LOG_FILE=$1
 
+if grep -q "Bootmode: UART" "$LOG_FILE"; then
+  boot_lines=(
+    "\[UART\] Boot loader at"
+    "\[UART\] Boot loader rejected corrupted frames"
+    "\[UART\] Loaded"
+    "\[UART\] Boot loader started core"
+  )
+else
+  boot_lines=(
+    "\[JTAG\] Loaded"
+    "\[CORE\] Start fetching instructions"
+    "\[JTAG\] Halting hart 0"
+    "\[JTAG\] Resumed hart 0"
+  )
+fi
+
 expected_lines=(
-  "\[CORE\] Start fetching instructions"
-  "\[JTAG\] Halting hart 0"
-  "\[JTAG\] Resumed hart 0"
+  "${boot_lines[@]}"
   "\[UART\] Hello World!"
   "\[UART\] Loopback received: internal msg"
   "\[UART\] Result: 0x8940, Cycles: 0xBD"
@@ -23,6 +23,7 @@ module core_wrap import croc_pkg::*; #() (
   output logic [31:0] instr_addr_o,
   input  logic [31:0] instr_rdata_i,
   input  logic        instr_err_i,
+  output logic        icache_inval_o, // FENCE.I executed
 
   // Data memory interface
   output logic        data_req_o,
@@ -104,7 +105,8 @@ module core_wrap import croc_pkg::*; #() (
 
     .debug_req_i,
     .fetch_enable_i,
-    .core_busy_o
+    .core_busy_o,
+    .icache_inval_o
   );
 
 endmodule
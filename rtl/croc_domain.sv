@@ -6,13 +6,15 @@
 // - Philippe Sauter <phsauter@iis.ee.ethz.ch>
 
 module croc_domain import croc_pkg::*; #(
-  parameter int unsigned GpioCount = 16
+  parameter int unsigned GpioCount    = 16,
+  parameter bit          ICacheEnable = croc_pkg::ICacheEnable
 ) (
   input  logic      clk_i,
   input  logic      rst_ni,
   input  logic      ref_clk_i,
   input  logic      testmode_i,
   input  logic      fetch_en_i,
+  input  logic      bootmode_i,
 
   input  logic      jtag_tck_i,
   input  logic      jtag_tdi_i,
@@ -50,6 +52,7 @@ module croc_domain import croc_pkg::*; #(
   logic debug_req;
   logic fetch_enable;
   logic [31:0] boot_addr;
+  bootmode_e bootmode;
 
   // interrupts (irqs)
   logic uart_irq;
@@ -77,6 +80,11 @@ module croc_domain import croc_pkg::*; #(
   assign core_instr_obi_req.a.be = '1;
   assign core_instr_obi_req.a.wdata = '0;
   assign core_instr_obi_req.a.a_optional = '0;
+  logic icache_inval;
+
+  // Instruction bus behind the instruction cache
+  mgr_obi_req_t xbar_instr_obi_req;
+  mgr_obi_rsp_t xbar_instr_obi_rsp;
 
   // Core data bus
   mgr_obi_req_t core_data_obi_req;
@@ -90,6 +98,10 @@ module croc_domain import croc_pkg::*; #(
   assign dbg_req_obi_req.a.aid = '0;
   assign dbg_req_obi_req.a.a_optional = '0;
 
+  // UART boot loader bus
+  mgr_obi_req_t uart_boot_obi_req;
+  mgr_obi_rsp_t uart_boot_obi_rsp;
+
   // ----------------------------------
   // Subordinate buses out of crossbar
   // ----------------------------------
@@ -156,6 +168,10 @@ module croc_domain import croc_pkg::*; #(
   // Timer periph bus
   sbr_obi_req_t timer_obi_req;
   sbr_obi_rsp_t timer_obi_rsp;
+
+  // Instruction cache periph bus
+  sbr_obi_req_t icache_obi_req;
+  sbr_obi_rsp_t icache_obi_rsp;
   
   // Fanout to individual peripherals
   assign error_obi_req                     = all_periph_obi_req[PeriphError];
@@ -170,6 +186,8 @@ module croc_domain import croc_pkg::*; #(
   assign all_periph_obi_rsp[PeriphGpio]    = gpio_obi_rsp;
   assign timer_obi_req                     = all_periph_obi_req[PeriphTimer];
   assign all_periph_obi_rsp[PeriphTimer]   = timer_obi_rsp;
+  assign icache_obi_req                    = all_periph_obi_req[PeriphICache];
+  assign all_periph_obi_rsp[PeriphICache]  = icache_obi_rsp;
 
 
   // -----------------
@@ -193,6 +211,7 @@ module croc_domain import croc_pkg::*; #(
     .instr_addr_o     ( core_instr_obi_req.a.addr  ),
     .instr_rdata_i    ( core_instr_obi_rsp.r.rdata ),
     .instr_err_i      ( core_instr_obi_rsp.r.err   ),
+    .icache_inval_o   ( icache_inval               ),
 
     .data_req_o       ( core_data_obi_req.req      ),
     .data_gnt_i       ( core_data_obi_rsp.gnt      ),
@@ -210,6 +229,56 @@ module croc_domain import croc_pkg::*; #(
     .core_busy_o     ( core_busy_o )
   );
 
+  // -----------------
+  // Instruction Cache
+  // -----------------
+
+  if (ICacheEnable) begin : gen_icache
+    icache #(
+      .ObiCfg          ( MgrObiCfg       ),
+      .obi_req_t       ( mgr_obi_req_t   ),
+      .obi_rsp_t       ( mgr_obi_rsp_t   ),
+      .RegObiCfg       ( SbrObiCfg       ),
+      .reg_obi_req_t   ( sbr_obi_req_t   ),
+      .reg_obi_rsp_t   ( sbr_obi_rsp_t   ),
+      .NumWays         ( ICacheNumWays   ),
+      .NumSets         ( ICacheNumSets   ),
+      .LineWords       ( ICacheLineWords ),
+      .CachedAddrStart ( UserBaseAddr    ),
+      .CachedAddrEnd   ( UserBaseAddr + UserAddrRange )
+    ) i_icache (
+      .clk_i,
+      .rst_ni,
+      .inval_i        ( icache_inval       ),
+
+      .core_obi_req_i ( core_instr_obi_req ),
+      .core_obi_rsp_o ( core_instr_obi_rsp ),
+      .mem_obi_req_o  ( xbar_instr_obi_req ),
+      .mem_obi_rsp_i  ( xbar_instr_obi_rsp ),
+
+      .reg_obi_req_i  ( icache_obi_req     ),
+      .reg_obi_rsp_o  ( icache_obi_rsp     )
+    );
+  end else begin : gen_no_icache
+    assign xbar_instr_obi_req = core_instr_obi_req;
+    assign core_instr_obi_rsp = xbar_instr_obi_rsp;
+
+    // the register window answers with an error
+    obi_err_sbr #(
+      .ObiCfg      ( SbrObiCfg     ),
+      .obi_req_t   ( sbr_obi_req_t ),
+      .obi_rsp_t   ( sbr_obi_rsp_t ),
+      .NumMaxTrans ( 1             ),
+      .RspData     ( 32'hBADCAB1E  )
+    ) i_icache_err (
+      .clk_i,
+      .rst_ni,
+      .testmode_i,
+      .obi_req_i  ( icache_obi_req ),
+      .obi_rsp_o  ( icache_obi_rsp )
+    );
+  end
+
   // -----------------
   // Debug Module
   // -----------------
@@ -325,13 +394,13 @@ module croc_domain import croc_pkg::*; #(
     .rst_ni,
     .testmode_i,
 
-    .sbr_ports_req_i  ( {core_instr_obi_req, core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i } ), // from managers towards subordinates
-    .sbr_ports_rsp_o  ( {core_instr_obi_rsp, core_data_obi_rsp, dbg_req_obi_rsp, user_mgr_obi_rsp_o } ),
+    .sbr_ports_req_i  ( {xbar_instr_obi_req, core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i, uart_boot_obi_req } ), // from managers towards subordinates
+    .sbr_ports_rsp_o  ( {xbar_instr_obi_rsp, core_data_obi_rsp, dbg_req_obi_rsp, user_mgr_obi_rsp_o, uart_boot_obi_rsp } ),
     .mgr_ports_req_o  ( all_sbr_obi_req ), // connections to subordinates
     .mgr_ports_rsp_i  ( all_sbr_obi_rsp ),
 
     .addr_map_i       ( croc_addr_map   ),
-    .en_default_idx_i ( 4'b1111          ),
+    .en_default_idx_i ( '1              ),
     .default_idx_i    ( '0              )
   );
 
@@ -504,6 +573,7 @@ module croc_domain import croc_pkg::*; #(
   assign fetch_enable    = soc_ctrl_reg2hw.fetchen.q | fetch_en_i;
   assign boot_addr       = soc_ctrl_reg2hw.bootaddr.q;
   assign sram_impl       = soc_ctrl_reg2hw.sram_dly;
+  assign bootmode        = bootmode_e'(soc_ctrl_reg2hw.bootmode.q | bootmode_i);
   assign soc_ctrl_hw2reg = '0;
 
   soc_ctrl_reg_top #(
@@ -521,6 +591,9 @@ module croc_domain import croc_pkg::*; #(
   );
 
   // UART
+  logic uart_periph_tx, uart_boot_tx, uart_boot_active;
+  assign uart_tx_o = uart_boot_active ? uart_boot_tx : uart_periph_tx;
+
   obi_uart #(
     .ObiCfg    ( SbrObiCfg     ),
     .obi_req_t ( sbr_obi_req_t ),
@@ -535,7 +608,7 @@ module croc_domain import croc_pkg::*; #(
     .irq_no    ( ), 
 
     .rxd_i     ( uart_rx_i ),
-    .txd_o     ( uart_tx_o ),
+    .txd_o     ( uart_periph_tx ),
 
     // Modem control pins are optional
     .cts_ni    ( 1'b1 ),
@@ -548,6 +621,30 @@ module croc_domain import croc_pkg::*; #(
     .out2_no   ( )
 );
 
+  // UART boot loader, owns the UART TX line until the core starts in UART bootmode
+  uart_boot #(
+    .ObiCfg        ( MgrObiCfg      ),
+    .obi_req_t     ( mgr_obi_req_t  ),
+    .obi_rsp_t     ( mgr_obi_rsp_t  ),
+    .DefaultClkDiv ( UartBootClkDiv ),
+    .BootAddrReg   ( SocCtrlAddrOffset + soc_ctrl_reg_pkg::SOC_CTRL_BOOTADDR_OFFSET ),
+    .FetchEnReg    ( SocCtrlAddrOffset + soc_ctrl_reg_pkg::SOC_CTRL_FETCHEN_OFFSET  )
+  ) i_uart_boot (
+    .clk_i,
+    .rst_ni,
+    .testmode_i,
+
+    .enable_i   ( bootmode == Uart  ),
+    .fetch_en_i ( fetch_enable      ),
+    .active_o   ( uart_boot_active  ),
+
+    .rxd_i      ( uart_rx_i         ),
+    .txd_o      ( uart_boot_tx      ),
+
+    .obi_req_o  ( uart_boot_obi_req ),
+    .obi_rsp_i  ( uart_boot_obi_rsp )
+  );
+
   // GPIO
   gpio #(
     .ObiCfg    ( SbrObiCfg     ),
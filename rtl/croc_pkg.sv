@@ -32,9 +32,19 @@ package croc_pkg;
   };
 
   typedef enum logic {
-    Jtag = 1'b0
+    Jtag = 1'b0,
+    Uart = 1'b1
   } bootmode_e;
 
+  // UART boot loader clock cycles per bit after reset (~115200 baud at 20MHz)
+  localparam int unsigned UartBootClkDiv = 174;
+
+  // Instruction cache for fetches from the user domain (see rtl/icache/README.md)
+  localparam bit          ICacheEnable    = 1'b0;
+  localparam int unsigned ICacheNumWays   = 2;  // 1 (direct-mapped) or 2
+  localparam int unsigned ICacheNumSets   = 8;
+  localparam int unsigned ICacheLineWords = 4;
+
   // Number of additional interrupts coming into croc_domain and going to the core
   localparam int unsigned NumExternalIrqs = 4;
 
@@ -70,7 +80,7 @@ package croc_pkg;
 
   localparam int unsigned NumCrocDomainSubordinates = 2 + NumSramBanks; // Peripherals + Memory + User Domain
   
-  localparam int unsigned NumXbarManagers = 4; // Debug module, Core Instr, Core Data, User Domain
+  localparam int unsigned NumXbarManagers = 5; // Debug module, Core Instr, Core Data, User Domain, UART Boot
   localparam int unsigned NumXbarSbrRules = NumCrocDomainSubordinates; // number of address rules in the decoder
   localparam int unsigned NumXbarSbr      = NumXbarSbrRules + 1; // additional OBI error, used for signal arrays
 
@@ -123,7 +133,10 @@ package croc_pkg;
   localparam bit [31:0] TimerAddrOffset   = 32'h0300_A000;
   localparam bit [31:0] TimerAddrRange    = 32'h0000_1000;
 
-  localparam int unsigned NumPeriphRules  = 5;
+  localparam bit [31:0] ICacheAddrOffset  = 32'h0300_B000;
+  localparam bit [31:0] ICacheAddrRange   = 32'h0000_1000;
+
+  localparam int unsigned NumPeriphRules  = 6;
   localparam int unsigned NumPeriphs      = NumPeriphRules + 1; // additional OBI error
 
   // Enum for bus indices
@@ -133,7 +146,8 @@ package croc_pkg;
     PeriphSocCtrl  = 2,
     PeriphUart     = 3,
     PeriphGpio     = 4,
-    PeriphTimer    = 5
+    PeriphTimer    = 5,
+    PeriphICache   = 6
   } periph_outputs_e;
 
   localparam addr_map_rule_t [NumPeriphRules-1:0] periph_addr_map = '{                                       // 0: OBI Error (default)
@@ -141,7 +155,8 @@ package croc_pkg;
     '{ idx: PeriphSocCtrl,  start_addr: SocCtrlAddrOffset,  end_addr: SocCtrlAddrOffset + SocCtrlAddrRange}, // 2: SoC control
     '{ idx: PeriphUart,     start_addr: UartAddrOffset,     end_addr: UartAddrOffset    + UartAddrRange},    // 3: UART
     '{ idx: PeriphGpio,     start_addr: GpioAddrOffset,     end_addr: GpioAddrOffset    + GpioAddrRange},    // 4: GPIO
-    '{ idx: PeriphTimer,    start_addr: TimerAddrOffset,    end_addr: TimerAddrOffset   + TimerAddrRange}    // 5: Timer
+    '{ idx: PeriphTimer,    start_addr: TimerAddrOffset,    end_addr: TimerAddrOffset   + TimerAddrRange},   // 5: Timer
+    '{ idx: PeriphICache,   start_addr: ICacheAddrOffset,   end_addr: ICacheAddrOffset  + ICacheAddrRange}   // 6: Instruction cache
   };
 
   // OBI is configured as 32 bit data, 32 bit address width
@@ -6,13 +6,16 @@
 // - Philippe Sauter <phsauter@iis.ee.ethz.ch>
 
 module croc_soc import croc_pkg::*; #(
-  parameter int unsigned GpioCount = 16
+  parameter int unsigned GpioCount        = 16,
+  parameter bit          ICacheEnable     = croc_pkg::ICacheEnable,
+  parameter bit          UserSimMemEnable = 1'b0  // simulation-only memory in the user domain
 ) (
   input  logic clk_i,
   input  logic rst_ni,
   input  logic ref_clk_i,
   input  logic testmode_i,
   input  logic fetch_en_i,
+  input  logic bootmode_i,
   output logic status_o,
 
   input  logic jtag_tck_i,
@@ -29,7 +32,7 @@ module croc_soc import croc_pkg::*; #(
   output logic [GpioCount-1:0] gpio_out_en_o // Output enable signal; 0 -> input, 1 -> output
 );
 
-  logic synced_rst_n, synced_fetch_en;
+  logic synced_rst_n, synced_fetch_en, synced_bootmode;
 
   rstgen i_rstgen (
     .clk_i,
@@ -49,6 +52,16 @@ module croc_soc import croc_pkg::*; #(
       .serial_o ( synced_fetch_en )
     );
 
+  sync #(
+      .STAGES     (    2 ),
+      .ResetValue ( 1'b0 )
+    ) i_bootmode_sync (
+      .clk_i,
+      .rst_ni   ( synced_rst_n    ),
+      .serial_i ( bootmode_i      ),
+      .serial_o ( synced_bootmode )
+    );
+
 // Connection between Croc_domain and User_domain: User Sbr, Croc Mgr
 sbr_obi_req_t user_sbr_obi_req;
 sbr_obi_rsp_t user_sbr_obi_rsp;
@@ -61,13 +74,15 @@ logic [NumExternalIrqs-1:0] interrupts;
 logic [GpioCount-1:0] gpio_in_sync;
 
 croc_domain #(
-  .GpioCount( GpioCount ) 
+  .GpioCount   ( GpioCount    ),
+  .ICacheEnable( ICacheEnable )
 ) i_croc (
   .clk_i,
   .rst_ni ( synced_rst_n ),
   .ref_clk_i,
   .testmode_i,
   .fetch_en_i ( synced_fetch_en ),
+  .bootmode_i ( synced_bootmode ),
 
   .jtag_tck_i,
   .jtag_tdi_i,
@@ -95,7 +110,8 @@ croc_domain #(
 );
 
 user_domain #(
-  .GpioCount( GpioCount ) 
+  .GpioCount        ( GpioCount        ),
+  .UserSimMemEnable ( UserSimMemEnable )
 ) i_user (
   .clk_i,
   .rst_ni ( synced_rst_n ),
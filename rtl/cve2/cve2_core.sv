@@ -103,7 +103,8 @@ module cve2_core import cve2_pkg::*; #(
 
   // CPU Control Signals
   input  logic                         fetch_enable_i,
-  output logic                         core_busy_o
+  output logic                         core_busy_o,
+  output logic                         icache_inval_o
 );
 
   localparam int unsigned PMP_NUM_CHAN      = 3;
@@ -376,6 +377,7 @@ module cve2_core import cve2_pkg::*; #(
     // IF and ID control signals
     .instr_first_cycle_id_o(instr_first_cycle_id),
     .instr_valid_clear_o   (instr_valid_clear),
+    .icache_inval_o        (icache_inval_o),
     .id_in_ready_o         (id_in_ready),
     .instr_req_o           (instr_req_int),
     .pc_set_o              (pc_set),
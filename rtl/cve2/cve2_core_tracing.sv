@@ -63,7 +63,8 @@ module cve2_core_tracing import cve2_pkg::*; #(
 
   // CPU Control Signals
   input  logic                         fetch_enable_i,
-  output logic                         core_busy_o
+  output logic                         core_busy_o,
+  output logic                         icache_inval_o
 
 );
 
@@ -190,7 +191,8 @@ module cve2_core_tracing import cve2_pkg::*; #(
     .rvfi_ext_mcycle,
 
     .fetch_enable_i,
-    .core_sleep_o
+    .core_sleep_o,
+    .icache_inval_o
   );
 
   cve2_tracer
@@ -30,6 +30,7 @@ module cve2_decoder #(
   output logic                 ecall_insn_o,          // syscall instr encountered
   output logic                 wfi_insn_o,            // wait for interrupt instr encountered
   output logic                 jump_set_o,            // jump taken set signal
+  output logic                 icache_inval_o,        // FENCE.I encountered
 
   // from IF-ID pipeline register
   input  logic                 instr_first_cycle_i,   // instruction read is in its first cycle
@@ -200,6 +201,7 @@ module cve2_decoder #(
   always_comb begin
     jump_in_dec_o         = 1'b0;
     jump_set_o            = 1'b0;
+    icache_inval_o        = 1'b0;
     branch_in_dec_o       = 1'b0;
 
     multdiv_operator_o    = MD_OP_MULL;
@@ -572,6 +574,7 @@ module cve2_decoder #(
 
             if (instr_first_cycle_i) begin
               jump_set_o       = 1'b1;
+              icache_inval_o   = 1'b1;
             end
           end
           default: begin
@@ -651,6 +654,7 @@ module cve2_decoder #(
       data_we_o       = 1'b0;
       jump_in_dec_o   = 1'b0;
       jump_set_o      = 1'b0;
+      icache_inval_o  = 1'b0;
       branch_in_dec_o = 1'b0;
       csr_access_o    = 1'b0;
     end
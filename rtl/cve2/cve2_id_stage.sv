@@ -37,6 +37,7 @@ module cve2_id_stage #(
   output logic                      instr_req_o,
   output logic                      instr_first_cycle_id_o,
   output logic                      instr_valid_clear_o,   // kill instr in IF-ID reg
+  output logic                      icache_inval_o,        // FENCE.I, invalidate instr caches
   output logic                      id_in_ready_o,         // ID stage is ready for next instr
 
   // Jumps and branches
@@ -168,6 +169,7 @@ module cve2_id_stage #(
   logic        jump_in_dec;
   logic        jump_set_dec;
   logic        jump_set, jump_set_raw;
+  logic        icache_inval_dec;
 
   logic        instr_first_cycle;
   logic        instr_executing_spec;
@@ -349,6 +351,7 @@ module cve2_id_stage #(
     .ecall_insn_o  (ecall_insn_dec),
     .wfi_insn_o    (wfi_insn_dec),
     .jump_set_o    (jump_set_dec),
+    .icache_inval_o(icache_inval_dec),
 
     // from IF-ID pipeline register
     .instr_first_cycle_i(instr_first_cycle),
@@ -596,6 +599,10 @@ module cve2_id_stage #(
   // ensures only the first cycle of a branch or jump set is sent to the controller to prevent
   // needless extra IF flushes and fetches.
   assign jump_set        = jump_set_raw        & ~branch_jump_set_done_q;
+
+  // The core has no instruction cache, FENCE.I only flushes the prefetch buffer (via the jump).
+  // Export the invalidate for external instruction caches, it may be held for several cycles.
+  assign icache_inval_o  = icache_inval_dec    & instr_executing;
   assign branch_set      = branch_set_raw      & ~branch_jump_set_done_q;
 
   ///////////////
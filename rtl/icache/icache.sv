@@ -0,0 +1,365 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+`include "common_cells/registers.svh"
+
+/// Small instruction cache for executing in place from slow memory (e.g. the user domain).
+/// Sits between the core instruction port and the interconnect. Fetches inside the cached
+/// region are served from a direct-mapped or 2-way set-associative cache, a miss refills the
+/// whole line with a burst of back-to-back OBI reads. All other fetches pass through unchanged.
+/// The registers and the invalidation are described in the README.md next to this file.
+module icache #(
+  /// The OBI configuration of the instruction ports.
+  parameter obi_pkg::obi_cfg_t ObiCfg    = obi_pkg::ObiDefaultConfig,
+  /// OBI request type of the instruction ports
+  parameter type obi_req_t               = logic,
+  /// OBI response type of the instruction ports
+  parameter type obi_rsp_t               = logic,
+  /// The OBI configuration of the register port.
+  parameter obi_pkg::obi_cfg_t RegObiCfg = obi_pkg::ObiDefaultConfig,
+  /// OBI request type of the register port
+  parameter type reg_obi_req_t           = logic,
+  /// OBI response type of the register port
+  parameter type reg_obi_rsp_t           = logic,
+  /// Associativity, 1 (direct-mapped) or 2.
+  parameter int unsigned NumWays         = 2,
+  /// Number of sets, a power of two (at least 2).
+  parameter int unsigned NumSets         = 8,
+  /// Words per cache line (refill burst length), a power of two (at least 2).
+  parameter int unsigned LineWords       = 4,
+  /// First address of the cached region.
+  parameter logic [31:0] CachedAddrStart = 32'h0,
+  /// First address after the cached region.
+  parameter logic [31:0] CachedAddrEnd   = 32'h0
+) (
+  /// Primary input clock
+  input  logic         clk_i,
+  /// Asynchronous active-low reset
+  input  logic         rst_ni,
+
+  /// Invalidate all lines (FENCE.I executed by the core), may be held for several cycles.
+  input  logic         inval_i,
+
+  /// Instruction port from the core (request).
+  input  obi_req_t     core_obi_req_i,
+  /// Instruction port from the core (response).
+  output obi_rsp_t     core_obi_rsp_o,
+
+  /// Instruction port into the interconnect (request).
+  output obi_req_t     mem_obi_req_o,
+  /// Instruction port into the interconnect (response).
+  input  obi_rsp_t     mem_obi_rsp_i,
+
+  /// Control interface from interconnect (request).
+  input  reg_obi_req_t reg_obi_req_i,
+  /// Control interface back into interconnect (response).
+  output reg_obi_rsp_t reg_obi_rsp_o
+);
+
+  localparam int unsigned WordOffsetWidth = $clog2(LineWords);
+  localparam int unsigned LineOffsetWidth = WordOffsetWidth + 2;
+  localparam int unsigned IndexWidth      = $clog2(NumSets);
+  localparam int unsigned TagWidth        = ObiCfg.AddrWidth - IndexWidth - LineOffsetWidth;
+  localparam int unsigned WayWidth        = cf_math_pkg::idx_width(NumWays);
+
+  // Register offsets within the 4 KiB register window
+  localparam logic [11:0] RegCtrl   = 12'h000;
+  localparam logic [11:0] RegHits   = 12'h004;
+  localparam logic [11:0] RegMisses = 12'h008;
+  // CTRL fields
+  localparam int unsigned CtrlEnableBit = 0;
+  localparam int unsigned CtrlFlushBit  = 1;
+  localparam int unsigned CtrlClearBit  = 2;
+
+  typedef logic [TagWidth-1:0]         tag_t;
+  typedef logic [IndexWidth-1:0]       index_t;
+  typedef logic [ObiCfg.DataWidth-1:0] data_t;
+
+  // Cache state; the data array has no reset, the valid bits guard it
+  logic  [NumWays-1:0][NumSets-1:0]                valid_q, valid_d;
+  tag_t  [NumWays-1:0][NumSets-1:0]                tag_q, tag_d;
+  data_t [NumWays-1:0][NumSets-1:0][LineWords-1:0] data_q;
+
+  // Line refill
+  logic                       refill_q, refill_d;
+  tag_t                       refill_tag_q, refill_tag_d;
+  index_t                     refill_index_q, refill_index_d;
+  logic [WayWidth-1:0]        refill_way_q, refill_way_d;
+  logic [WordOffsetWidth:0]   refill_req_cnt_q, refill_req_cnt_d; // words requested
+  logic [WordOffsetWidth-1:0] refill_rsp_cnt_q, refill_rsp_cnt_d; // words received
+  logic                       refill_err_q, refill_err_d;
+  logic                       refill_stale_q, refill_stale_d;     // invalidated during refill
+  logic                       refilled_q, refilled_d;             // next hit is the missed fetch
+
+  // Uncached fetches passing through
+  logic [1:0] pass_cnt_q, pass_cnt_d;         // outstanding pass-through responses
+  logic       bypass_next_q, bypass_next_d;   // the last refill failed, fetch uncached once
+
+  // Hit response (one cycle after the grant)
+  logic                      hit_valid_q, hit_valid_d;
+  data_t                     hit_rdata_q, hit_rdata_d;
+  logic [ObiCfg.IdWidth-1:0] hit_rid_q, hit_rid_d;
+
+  // Registers
+  logic        enable_q, enable_d;
+  logic [31:0] hits_q, hits_d;
+  logic [31:0] misses_q, misses_d;
+  logic        flush, clear;
+
+  logic inval;
+  assign inval = inval_i | flush | ~enable_q;
+
+
+  //-----------------------------------------------------------------------------------------------
+  // Lookup
+  //-----------------------------------------------------------------------------------------------
+  tag_t                       core_tag;
+  index_t                     core_index;
+  logic [WordOffsetWidth-1:0] core_word;
+  logic                       cached, lookup, hit, miss, hit_gnt, pass_req;
+  logic [NumWays-1:0]         hit_way;
+  logic [WayWidth-1:0]        victim_way;
+  data_t                      hit_rdata;
+
+  assign core_tag   = core_obi_req_i.a.addr[ObiCfg.AddrWidth-1 -: TagWidth];
+  assign core_index = core_obi_req_i.a.addr[LineOffsetWidth +: IndexWidth];
+  assign core_word  = core_obi_req_i.a.addr[2 +: WordOffsetWidth];
+
+  assign cached = enable_q & ~bypass_next_q &
+                  (core_obi_req_i.a.addr >= CachedAddrStart) &
+                  (core_obi_req_i.a.addr <  CachedAddrEnd);
+
+  // Responses are returned in order: a cached fetch waits for outstanding pass-through responses,
+  // nothing is granted during a refill (the core stalls on the missing fetch anyway).
+  assign lookup   = core_obi_req_i.req & cached & ~refill_q & ~inval & (pass_cnt_q == '0);
+  assign hit      = |hit_way;
+  assign hit_gnt  = lookup &  hit;
+  assign miss     = lookup & ~hit;
+  assign pass_req = core_obi_req_i.req & ~cached & ~refill_q & (pass_cnt_q != '1);
+
+  always_comb begin
+    hit_rdata = '0;
+    for (int unsigned w = 0; w < NumWays; w++) begin
+      hit_way[w] = valid_q[w][core_index] & (tag_q[w][core_index] == core_tag);
+      if (hit_way[w]) begin
+        hit_rdata |= data_q[w][core_index][core_word];
+      end
+    end
+  end
+
+  if (NumWays == 2) begin : gen_lru
+    logic [NumSets-1:0] lru_q, lru_d; // way replaced next, per set
+
+    // fill an empty way first, otherwise replace the least recently used
+    assign victim_way = ~valid_q[0][core_index] ? 1'b0 :
+                        ~valid_q[1][core_index] ? 1'b1 : lru_q[core_index];
+
+    always_comb begin
+      lru_d = lru_q;
+      if (hit_gnt) lru_d[core_index] = hit_way[0];
+      if (miss)    lru_d[core_index] = ~victim_way;
+    end
+
+    `FF(lru_q, lru_d, '0, clk_i, rst_ni)
+  end else begin : gen_direct_mapped
+    assign victim_way = '0;
+  end
+
+
+  //-----------------------------------------------------------------------------------------------
+  // Control
+  //-----------------------------------------------------------------------------------------------
+  always_comb begin
+    valid_d          = valid_q;
+    tag_d            = tag_q;
+    refill_d         = refill_q;
+    refill_tag_d     = refill_tag_q;
+    refill_index_d   = refill_index_q;
+    refill_way_d     = refill_way_q;
+    refill_req_cnt_d = refill_req_cnt_q;
+    refill_rsp_cnt_d = refill_rsp_cnt_q;
+    refill_err_d     = refill_err_q;
+    refill_stale_d   = refill_stale_q;
+    refilled_d       = refilled_q & ~core_obi_rsp_o.gnt;
+    pass_cnt_d       = pass_cnt_q;
+    bypass_next_d    = bypass_next_q;
+
+    hit_valid_d = hit_gnt;
+    hit_rdata_d = hit_rdata;
+    hit_rid_d   = core_obi_req_i.a.aid;
+
+    // start a refill, the fetch is granted once the line is valid
+    if (miss) begin
+      refill_d         = 1'b1;
+      refill_tag_d     = core_tag;
+      refill_index_d   = core_index;
+      refill_way_d     = victim_way;
+      refill_req_cnt_d = '0;
+      refill_rsp_cnt_d = '0;
+      refill_err_d     = 1'b0;
+      refill_stale_d   = 1'b0;
+      valid_d[victim_way][core_index] = 1'b0;
+    end
+
+    if (refill_q) begin
+      if (mem_obi_req_o.req && mem_obi_rsp_i.gnt) begin
+        refill_req_cnt_d = refill_req_cnt_q + 1;
+      end
+      if (mem_obi_rsp_i.rvalid) begin
+        refill_rsp_cnt_d = refill_rsp_cnt_q + 1;
+        refill_err_d     = refill_err_q | mem_obi_rsp_i.r.err;
+        if (refill_rsp_cnt_q == WordOffsetWidth'(LineWords-1)) begin
+          refill_d   = 1'b0;
+          refilled_d = 1'b1;
+          if (!(refill_err_d || refill_stale_q || inval)) begin
+            valid_d[refill_way_q][refill_index_q] = 1'b1;
+            tag_d  [refill_way_q][refill_index_q] = refill_tag_q;
+          end
+          // let the bus error reach the core with an uncached fetch
+          bypass_next_d = refill_err_d;
+        end
+      end
+    end
+
+    if (inval) begin
+      valid_d        = '0;
+      refill_stale_d = refill_stale_d | refill_q;
+    end
+
+    // pass-through bookkeeping, no pass-through is outstanding during a refill
+    if (pass_req && mem_obi_rsp_i.gnt) begin
+      bypass_next_d = 1'b0;
+      if (!mem_obi_rsp_i.rvalid) pass_cnt_d = pass_cnt_q + 1;
+    end else if (!refill_q && mem_obi_rsp_i.rvalid) begin
+      pass_cnt_d = pass_cnt_q - 1;
+    end
+  end
+
+  always_ff @(posedge clk_i) begin
+    if (refill_q && mem_obi_rsp_i.rvalid) begin
+      data_q[refill_way_q][refill_index_q][refill_rsp_cnt_q] <= mem_obi_rsp_i.r.rdata;
+    end
+  end
+
+  `FF(valid_q,          valid_d,          '0,   clk_i, rst_ni)
+  `FF(tag_q,            tag_d,            '0,   clk_i, rst_ni)
+  `FF(refill_q,         refill_d,         1'b0, clk_i, rst_ni)
+  `FF(refill_tag_q,     refill_tag_d,     '0,   clk_i, rst_ni)
+  `FF(refill_index_q,   refill_index_d,   '0,   clk_i, rst_ni)
+  `FF(refill_way_q,     refill_way_d,     '0,   clk_i, rst_ni)
+  `FF(refill_req_cnt_q, refill_req_cnt_d, '0,   clk_i, rst_ni)
+  `FF(refill_rsp_cnt_q, refill_rsp_cnt_d, '0,   clk_i, rst_ni)
+  `FF(refill_err_q,     refill_err_d,     1'b0, clk_i, rst_ni)
+  `FF(refill_stale_q,   refill_stale_d,   1'b0, clk_i, rst_ni)
+  `FF(refilled_q,       refilled_d,       1'b0, clk_i, rst_ni)
+  `FF(pass_cnt_q,       pass_cnt_d,       '0,   clk_i, rst_ni)
+  `FF(bypass_next_q,    bypass_next_d,    1'b0, clk_i, rst_ni)
+  `FF(hit_valid_q,      hit_valid_d,      1'b0, clk_i, rst_ni)
+  `FF(hit_rdata_q,      hit_rdata_d,      '0,   clk_i, rst_ni)
+  `FF(hit_rid_q,        hit_rid_d,        '0,   clk_i, rst_ni)
+
+
+  //-----------------------------------------------------------------------------------------------
+  // Instruction ports
+  //-----------------------------------------------------------------------------------------------
+  always_comb begin
+    mem_obi_req_o = '0;
+    if (refill_q) begin
+      mem_obi_req_o.req    = (refill_req_cnt_q != LineWords);
+      mem_obi_req_o.a.addr = {refill_tag_q, refill_index_q,
+                              refill_req_cnt_q[WordOffsetWidth-1:0], 2'b00};
+      mem_obi_req_o.a.be   = '1;
+    end else begin
+      mem_obi_req_o.req    = pass_req;
+      mem_obi_req_o.a      = core_obi_req_i.a;
+    end
+  end
+
+  always_comb begin
+    core_obi_rsp_o     = '0;
+    core_obi_rsp_o.gnt = hit_gnt | (pass_req & mem_obi_rsp_i.gnt);
+    if (hit_valid_q) begin
+      core_obi_rsp_o.rvalid  = 1'b1;
+      core_obi_rsp_o.r.rdata = hit_rdata_q;
+      core_obi_rsp_o.r.rid   = hit_rid_q;
+    end else if (!refill_q) begin
+      core_obi_rsp_o.rvalid  = mem_obi_rsp_i.rvalid;
+      core_obi_rsp_o.r       = mem_obi_rsp_i.r;
+    end
+  end
+
+
+  //-----------------------------------------------------------------------------------------------
+  // Registers
+  //-----------------------------------------------------------------------------------------------
+  logic                           reg_valid_q;
+  logic                           reg_err_q, reg_err_d;
+  logic [RegObiCfg.DataWidth-1:0] reg_rdata_q, reg_rdata_d;
+  logic [RegObiCfg.IdWidth-1:0]   reg_rid_q;
+
+  always_comb begin
+    enable_d    = enable_q;
+    flush       = 1'b0;
+    clear       = 1'b0;
+    reg_rdata_d = '0;
+    reg_err_d   = 1'b0;
+
+    if (reg_obi_req_i.req) begin
+      unique case (reg_obi_req_i.a.addr[11:0])
+        RegCtrl: begin
+          if (reg_obi_req_i.a.we && reg_obi_req_i.a.be[0]) begin
+            enable_d = reg_obi_req_i.a.wdata[CtrlEnableBit];
+            flush    = reg_obi_req_i.a.wdata[CtrlFlushBit];
+            clear    = reg_obi_req_i.a.wdata[CtrlClearBit];
+          end
+          reg_rdata_d[CtrlEnableBit] = enable_q;
+        end
+        RegHits: begin
+          reg_rdata_d = hits_q;
+          reg_err_d   = reg_obi_req_i.a.we;
+        end
+        RegMisses: begin
+          reg_rdata_d = misses_q;
+          reg_err_d   = reg_obi_req_i.a.we;
+        end
+        default: reg_err_d = 1'b1;
+      endcase
+    end
+  end
+
+  // the fetch that missed is served from the cache after the refill, count it only as a miss
+  assign hits_d   = clear ? '0 : hits_q   + 32'(hit_gnt & ~refilled_q);
+  assign misses_d = clear ? '0 : misses_q + 32'(miss);
+
+  always_comb begin
+    reg_obi_rsp_o         = '0;
+    reg_obi_rsp_o.gnt     = reg_obi_req_i.req;
+    reg_obi_rsp_o.rvalid  = reg_valid_q;
+    reg_obi_rsp_o.r.rdata = reg_rdata_q;
+    reg_obi_rsp_o.r.rid   = reg_rid_q;
+    reg_obi_rsp_o.r.err   = reg_err_q;
+  end
+
+  `FF(enable_q,    enable_d,              1'b1, clk_i, rst_ni)
+  `FF(hits_q,      hits_d,                '0,   clk_i, rst_ni)
+  `FF(misses_q,    misses_d,              '0,   clk_i, rst_ni)
+  `FF(reg_valid_q, reg_obi_req_i.req,     1'b0, clk_i, rst_ni)
+  `FF(reg_err_q,   reg_err_d,             1'b0, clk_i, rst_ni)
+  `FF(reg_rdata_q, reg_rdata_d,           '0,   clk_i, rst_ni)
+  `FF(reg_rid_q,   reg_obi_req_i.a.aid,   '0,   clk_i, rst_ni)
+
+
+  // pragma translate_off
+  `ifndef VERILATOR
+  initial begin : p_param_check
+    assert (NumWays inside {1, 2}) else $fatal(1, "NumWays must be 1 or 2");
+    assert (NumSets >= 2 && 2**IndexWidth == NumSets)
+      else $fatal(1, "NumSets must be a power of two (at least 2)");
+    assert (LineWords >= 2 && 2**WordOffsetWidth == LineWords)
+      else $fatal(1, "LineWords must be a power of two (at least 2)");
+  end
+  `endif
+  // pragma translate_on
+
+endmodule
@@ -17,6 +17,12 @@ module tb_croc_soc #(
     // UART
     parameter int unsigned  UartBaudRate      = 115200,
     parameter int unsigned  UartParityEna     = 0,
+    // UART boot: clock cycles per bit negotiated with the loader and payload bytes per frame
+    parameter int unsigned  UartBootFastClkDiv = 10,
+    parameter int unsigned  UartBootBlockSize  = 256,
+    // Instruction cache and simulation memory in the user domain (both needed by sw/xip.c)
+    parameter bit           ICacheEnable       = croc_pkg::ICacheEnable,
+    parameter bit           UserSimMemEnable   = 1'b0,
 
     localparam int unsigned ClkFrequency = 1s / ClkPeriod
 )();
@@ -34,6 +40,7 @@ module tb_croc_soc #(
     logic uart_tx_o;
 
     logic fetch_en_i;
+    logic bootmode_i;
     logic status_o;
 
     localparam int unsigned GpioCount = 32;
@@ -54,6 +61,7 @@ module tb_croc_soc #(
     //  Command Line Arguments //
     /////////////////////////////
     string binary_path;
+    string bootmode_str;
     initial begin
         if ($value$plusargs("binary=%s", binary_path)) begin
             $display("Running program: %s", binary_path);
@@ -61,8 +69,20 @@ module tb_croc_soc #(
             $display("No binary path provided. Running helloworld.");
             binary_path = "../sw/bin/helloworld.hex";
         end
+        bootmode_i = croc_pkg::Jtag;
+        if ($value$plusargs("bootmode=%s", bootmode_str)) begin
+            if (bootmode_str == "uart") bootmode_i = croc_pkg::Uart;
+            else if (bootmode_str != "jtag") $fatal(1, "Unknown bootmode %s (jtag, uart)", bootmode_str);
+        end
+        $display("Bootmode: %s", bootmode_i == croc_pkg::Uart ? "UART" : "JTAG");
     end
 
+    // Report how fast a binary was loaded into memory
+    task automatic print_load_stats(input string iface, input int unsigned num_bytes, input time duration);
+        $display("@%t | [%s] Loaded %0d bytes in %t (%0.1f KiB/s)", $time, iface, num_bytes, duration,
+                 (num_bytes / 1024.0) / (duration / 1.0s));
+    endtask
+
 
     //////////////
     //  Clocks  //
@@ -225,6 +245,8 @@ module tb_croc_soc #(
         bit [31:0] data;
         bit [7:0] byte_data;
         int byte_count;
+        int unsigned total_bytes = 0;
+        time start_time = $time;
         static dm::sbcs_t sbcs = dm::sbcs_t'{sbautoincrement: 1'b1, sbaccess: 2, default: '0};
 
         file = $fopen(filename, "r");
@@ -277,11 +299,13 @@ module tb_croc_soc #(
                     addr += 4;
                     data = 32'h0;
                     byte_count = 0;
+                    total_bytes += 4;
                 end
             end
         end
         jtag_dbg.write_dmi(dm::SBCS, JtagInitSbcs);
         $fclose(file);
+        print_load_stats("JTAG", total_bytes, $time - start_time);
     endtask
 
     // Wait for termination signal and get return code
@@ -316,35 +340,44 @@ module tb_croc_soc #(
     localparam byte_bt UartDebugCmdRead  = 'h11;
     localparam byte_bt UartDebugCmdWrite = 'h12;
     localparam byte_bt UartDebugCmdExec  = 'h13;
+    localparam byte_bt UartDebugCmdBaud  = 'h16;
     localparam byte_bt UartDebugAck      = 'h06;
+    localparam byte_bt UartDebugNak      = 'h15;
     localparam byte_bt UartDebugEot      = 'h04;
     localparam byte_bt UartDebugEoc      = 'h14;
+    // bit periods the boot loader may take to answer after the end of a frame
+    localparam int unsigned UartBootRspTimeoutBits = 256;
 
     logic   uart_reading_byte;
+    logic   uart_console_en;
+    // bit period of the UART, changes while talking to the UART boot loader
+    time    uart_baud_period;
 
     initial begin
         uart_rx_i         = 1'b1;
         uart_reading_byte = 1'b0;
+        uart_console_en   = 1'b0;
+        uart_baud_period  = UartBaudPeriod;
     end
 
     task automatic uart_read_byte(output byte_bt bite);
         // Start bit
         @(negedge uart_tx_o);
         uart_reading_byte = 1;
-        #(UartBaudPeriod/2);
+        #(uart_baud_period/2);
         // 8-bit byte
         for (int i = 0; i < 8; i++) begin
-        #UartBaudPeriod bite[i] = uart_tx_o;
+        #uart_baud_period bite[i] = uart_tx_o;
         end
         // Parity bit
         if(UartParityEna) begin
         bit parity;
-        #UartBaudPeriod parity = uart_tx_o;
+        #uart_baud_period parity = uart_tx_o;
         if(parity ^ (^bite))
             $error("[UART] - Parity error detected!");
         end
         // Stop bit
-        #UartBaudPeriod;
+        #uart_baud_period;
         uart_reading_byte=0;
     endtask
 
@@ -353,13 +386,163 @@ module tb_croc_soc #(
         uart_rx_i = 1'b0;
         // 8-bit byte
         for (int i = 0; i < 8; i++)
-        #UartBaudPeriod uart_rx_i = bite[i];
+        #uart_baud_period uart_rx_i = bite[i];
         // Parity bit
         if (UartParityEna)
-        #UartBaudPeriod uart_rx_i = (^bite);
+        #uart_baud_period uart_rx_i = (^bite);
         // Stop bit
-        #UartBaudPeriod uart_rx_i = 1'b1;
-        #UartBaudPeriod;
+        #uart_baud_period uart_rx_i = 1'b1;
+        #uart_baud_period;
+    endtask
+
+
+    ////////////////////////
+    //  UART Boot Tasks   //
+    ////////////////////////
+
+    // CRC-32 update with one byte, same as zlib crc32 and the loader
+    function automatic bit [31:0] uart_boot_crc32(input bit [31:0] crc, input byte_bt bite);
+        crc ^= {24'h0, bite};
+        for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (32'hEDB8_8320 & {32{crc[0]}});
+        return crc;
+    endfunction
+
+    // Send one frame (cmd, addr, len, header crc[, payload, payload crc]) and return the
+    // loaders response. A missing response fails the simulation instead of hanging it.
+    // The flip masks corrupt the checksums to test the rejection paths.
+    task automatic uart_boot_frame(
+        input  byte_bt    cmd,
+        input  bit [31:0] addr,
+        input  byte_bt    payload[$],
+        output byte_bt    rsp,
+        input  bit [31:0] hcrc_flip = '0,
+        input  bit [31:0] crc_flip  = '0
+    );
+        byte_bt frame[$];
+        bit [31:0] len = payload.size();
+        bit [31:0] crc = '1;
+        frame = {cmd, addr[7:0], addr[15:8], addr[23:16], addr[31:24],
+                 len[7:0], len[15:8], len[23:16], len[31:24]};
+        foreach (frame[i]) crc = uart_boot_crc32(crc, frame[i]);
+        crc = ~crc ^ hcrc_flip;
+        frame = {frame, crc[7:0], crc[15:8], crc[23:16], crc[31:24]};
+        if (len != 0) begin
+            crc = '1;
+            foreach (payload[i]) crc = uart_boot_crc32(crc, payload[i]);
+            crc = ~crc ^ crc_flip;
+            frame = {frame, payload, crc[7:0], crc[15:8], crc[23:16], crc[31:24]};
+        end
+        // the response may start during the last stop bit
+        fork
+            begin
+                fork
+                    uart_read_byte(rsp);
+                    begin
+                        foreach (frame[i]) uart_write_byte(frame[i]);
+                        // a rejected header is answered after the loaders idle timeout
+                        #(UartBootRspTimeoutBits * uart_baud_period);
+                        $fatal(1, "@%t | [UART] No response to boot command 0x%h", $time, cmd);
+                    end
+                join_any
+                disable fork;
+            end
+        join
+    endtask
+
+    // Send a frame, retry if the loader rejects it
+    task automatic uart_boot_cmd(input byte_bt cmd, input bit [31:0] addr, input byte_bt payload[$]);
+        byte_bt rsp;
+        for (int retry = 0; retry < 3; retry++) begin
+            uart_boot_frame(cmd, addr, payload, rsp);
+            if (rsp == UartDebugAck) return;
+            $display("@%t | [UART] Boot command 0x%h rejected (0x%h), retrying", $time, cmd, rsp);
+        end
+        $fatal(1, "@%t | [UART] Boot command 0x%h failed", $time, cmd);
+    endtask
+
+    // Send corrupted frames, they must be rejected without disturbing the next frame
+    task automatic uart_boot_check_reject();
+        byte_bt rsp;
+        byte_bt payload[$] = {8'h78, 8'h56, 8'h34, 8'h12};
+        // payload CRC mismatch, rejected at the end of the frame
+        uart_boot_frame(UartDebugCmdWrite, croc_pkg::SramBaseAddr, payload, rsp, '0, 32'h1);
+        if (rsp != UartDebugNak)
+            $fatal(1, "@%t | [UART] Payload CRC error not rejected (0x%h)", $time, rsp);
+        // header CRC mismatch, the rest of the frame is drained and rejected once the line is idle
+        uart_boot_frame(UartDebugCmdWrite, croc_pkg::SramBaseAddr, payload, rsp, 32'h1, '0);
+        if (rsp != UartDebugNak)
+            $fatal(1, "@%t | [UART] Header CRC error not rejected (0x%h)", $time, rsp);
+        // the loader is ready for the next frame
+        uart_boot_frame(UartDebugCmdWrite, croc_pkg::SramBaseAddr, payload, rsp);
+        if (rsp != UartDebugAck)
+            $fatal(1, "@%t | [UART] Frame after rejected frames not accepted (0x%h)", $time, rsp);
+        $display("@%t | [UART] Boot loader rejected corrupted frames", $time);
+    endtask
+
+    // Switch loader and testbench to a faster baud rate
+    task automatic uart_boot_baud(input int unsigned clk_div);
+        uart_boot_cmd(UartDebugCmdBaud, clk_div, {});
+        // the loader switches once its acknowledge is fully sent
+        #uart_baud_period;
+        uart_baud_period = clk_div * ClkPeriod;
+        $display("@%t | [UART] Boot loader at %0d baud", $time, 1s / uart_baud_period);
+    endtask
+
+    // Load the binary formated as 32bit hex file in blocks of UartBootBlockSize bytes
+    task automatic uart_boot_load_hex(input string filename);
+        int file;
+        string line;
+        bit [31:0] addr, block_addr;
+        byte_bt byte_data;
+        byte_bt block[$];
+        int unsigned total_bytes = 0;
+        time start_time = $time;
+
+        file = $fopen(filename, "r");
+        if (file == 0) $fatal(1, "Error: Failed to open file %s", filename);
+        $display("@%t | [UART] Loading binary from %s", $time, filename);
+
+        while (!$feof(file)) begin
+            if ($fgets(line, file) == 0) break;
+            // '@' indicates address, a discontinuity ends the current block
+            if (line[0] == "@") begin
+                if ($sscanf(line, "@%h", addr) != 1)
+                    $fatal(1, "Error: Incorrect address line format in file %s", filename);
+                if (block.size() > 0 && addr != block_addr + block.size()) begin
+                    while (block.size() % 4) block.push_back('0);
+                    uart_boot_cmd(UartDebugCmdWrite, block_addr, block);
+                    total_bytes += block.size();
+                    block.delete();
+                end
+                if (block.size() == 0) block_addr = addr;
+                continue;
+            end
+            while ($sscanf(line, "%h", byte_data) == 1) begin
+                block.push_back(byte_data);
+                line = line.substr(3, line.len()-1);
+                if (block.size() == UartBootBlockSize) begin
+                    uart_boot_cmd(UartDebugCmdWrite, block_addr, block);
+                    total_bytes += block.size();
+                    block_addr += block.size();
+                    block.delete();
+                end
+            end
+        end
+        if (block.size() > 0) begin
+            while (block.size() % 4) block.push_back('0);
+            uart_boot_cmd(UartDebugCmdWrite, block_addr, block);
+            total_bytes += block.size();
+        end
+        $fclose(file);
+        print_load_stats("UART", total_bytes, $time - start_time);
+    endtask
+
+    // Set the boot address and start the core, UART is handed back to the core
+    task automatic uart_boot_exec(input bit [31:0] boot_addr);
+        uart_boot_cmd(UartDebugCmdExec, boot_addr, {});
+        #uart_baud_period;
+        uart_baud_period = UartBaudPeriod;
+        $display("@%t | [UART] Boot loader started core at 0x%h", $time, boot_addr);
     endtask
 
     // Continually read characters and print lines
@@ -368,7 +551,7 @@ module tb_croc_soc #(
         static byte_bt uart_read_buf[$];
         byte_bt bite;
         
-        @(posedge fetch_en_i);
+        wait (uart_console_en);
         uart_read_buf.delete();
         forever begin
             uart_read_byte(bite);
@@ -404,7 +587,9 @@ module tb_croc_soc #(
         \croc_soc$croc_chip.i_croc_soc i_croc_soc (
     `else
         croc_soc #(
-            .GpioCount ( GpioCount  )
+            .GpioCount        ( GpioCount        ),
+            .ICacheEnable     ( ICacheEnable     ),
+            .UserSimMemEnable ( UserSimMemEnable )
         ) i_croc_soc (
     `endif
         .clk_i         ( clk        ),
@@ -412,6 +597,7 @@ module tb_croc_soc #(
         .ref_clk_i     ( ref_clk    ),
         .testmode_i    ( 1'b0       ),
         .fetch_en_i    ( fetch_en_i ),
+        .bootmode_i    ( bootmode_i ),
         .status_o      ( status_o   ),
 
         .jtag_tck_i    ( jtag_tck_i   ),
@@ -455,19 +641,29 @@ module tb_croc_soc #(
         // init jtag
         jtag_init();
 
-        // write test value to sram
-        jtag_write_reg32(croc_pkg::SramBaseAddr, 32'h1234_5678, 1'b1);
-        // load binary to sram
-        jtag_load_hex(binary_path);
+        if (bootmode_i == croc_pkg::Uart) begin
+            // load binary to sram and start the core via the UART boot loader
+            uart_boot_baud(UartBootFastClkDiv);
+            uart_boot_check_reject();
+            uart_boot_load_hex(binary_path);
+            uart_boot_exec(croc_pkg::SramBaseAddr);
+            uart_console_en = 1'b1;
+        end else begin
+            // write test value to sram
+            jtag_write_reg32(croc_pkg::SramBaseAddr, 32'h1234_5678, 1'b1);
+            // load binary to sram
+            jtag_load_hex(binary_path);
 
-        $display("@%t | [CORE] Start fetching instructions", $time);
-        fetch_en_i = 1'b1;
+            $display("@%t | [CORE] Start fetching instructions", $time);
+            fetch_en_i      = 1'b1;
+            uart_console_en = 1'b1;
 
-        // halt core
-        jtag_halt();
+            // halt core
+            jtag_halt();
 
-        // resume core
-        jtag_resume();
+            // resume core
+            jtag_resume();
+        end
 
         // wait for non-zero return value (written into core status register)
         $display("@%t | [CORE] Wait for end of code...", $time);
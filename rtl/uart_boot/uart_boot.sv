@@ -0,0 +1,544 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+`include "common_cells/registers.svh"
+
+/// UART boot loader.
+/// Receives CRC32-checked command frames over UART and executes them as OBI transactions,
+/// allowing a host to load a binary into memory and start the core without using JTAG.
+/// The frame format and commands are described in the README.md next to this file.
+module uart_boot #(
+  /// The OBI configuration of the manager port.
+  parameter obi_pkg::obi_cfg_t ObiCfg = obi_pkg::ObiDefaultConfig,
+  /// OBI request type
+  parameter type obi_req_t            = logic,
+  /// OBI response type
+  parameter type obi_rsp_t            = logic,
+  /// Clock cycles per UART bit after reset (changed by the baud command).
+  parameter int unsigned DefaultClkDiv = 174,
+  /// Smallest clock divider accepted by the baud command.
+  parameter int unsigned MinClkDiv     = 4,
+  /// Address of the boot address register (written by the exec command).
+  parameter logic [31:0] BootAddrReg   = 32'h0,
+  /// Address of the fetch enable register (written by the exec command).
+  parameter logic [31:0] FetchEnReg    = 32'h0,
+  /// Number of received bytes buffered while the loader is busy on the bus.
+  parameter int unsigned RxFifoDepth   = 4
+) (
+  /// Primary input clock
+  input  logic     clk_i,
+  /// Asynchronous active-low reset
+  input  logic     rst_ni,
+  input  logic     testmode_i,
+
+  /// Boot mode selects UART boot; the loader ignores the UART otherwise.
+  input  logic     enable_i,
+  /// Core fetch is enabled; the loader retires until the next reset.
+  input  logic     fetch_en_i,
+  /// The loader is active and owns the UART TX line.
+  output logic     active_o,
+
+  /// UART receive line (Host -> SoC)
+  input  logic     rxd_i,
+  /// UART transmit line (SoC -> Host)
+  output logic     txd_o,
+
+  /// Manager port into the interconnect (request).
+  output obi_req_t obi_req_o,
+  /// Manager port into the interconnect (response).
+  input  obi_rsp_t obi_rsp_i
+);
+
+  // Commands (first byte of a frame)
+  localparam logic [7:0] CmdRead  = 8'h11;
+  localparam logic [7:0] CmdWrite = 8'h12;
+  localparam logic [7:0] CmdExec  = 8'h13;
+  localparam logic [7:0] CmdBaud  = 8'h16;
+  // Responses
+  localparam logic [7:0] RspAck   = 8'h06;
+  localparam logic [7:0] RspNak   = 8'h15;
+
+  localparam logic [31:0] CrcInit = 32'hFFFF_FFFF;
+
+  // abort a partially received frame if the line is idle for this many bit periods
+  localparam int unsigned TimeoutBits = 64;
+  localparam int unsigned TimeoutWidth = 16 + $clog2(TimeoutBits);
+
+  // CRC-32 (IEEE 802.3, reflected) update with one byte, same as zlib/binascii crc32
+  function automatic logic [31:0] crc32_byte(input logic [31:0] crc, input logic [7:0] data);
+    logic [31:0] c;
+    c = crc ^ {24'h0, data};
+    for (int i = 0; i < 8; i++) begin
+      c = (c >> 1) ^ (32'hEDB8_8320 & {32{c[0]}});
+    end
+    return c;
+  endfunction
+
+  // Clock cycles per bit
+  logic [15:0] clk_div_q, clk_div_d;
+
+
+  //-----------------------------------------------------------------------------------------------
+  // Receiver
+  //-----------------------------------------------------------------------------------------------
+  typedef enum logic [1:0] { RxIdle, RxStart, RxData, RxStop } rx_state_e;
+
+  rx_state_e   rx_state_q, rx_state_d;
+  logic [15:0] rx_cnt_q, rx_cnt_d;
+  logic [ 2:0] rx_bit_q, rx_bit_d;
+  logic [ 7:0] rx_shift_q, rx_shift_d;
+  logic        rx_valid;
+  logic        rxd_sync;
+
+  sync #(
+    .STAGES     (    2 ),
+    .ResetValue ( 1'b1 )
+  ) i_rxd_sync (
+    .clk_i,
+    .rst_ni,
+    .serial_i ( rxd_i    ),
+    .serial_o ( rxd_sync )
+  );
+
+  always_comb begin
+    rx_state_d = rx_state_q;
+    rx_cnt_d   = rx_cnt_q;
+    rx_bit_d   = rx_bit_q;
+    rx_shift_d = rx_shift_q;
+    rx_valid   = 1'b0;
+
+    if (rx_state_q != RxIdle) begin
+      rx_cnt_d = rx_cnt_q - 1;
+    end
+
+    unique case (rx_state_q)
+      RxIdle: begin
+        if (!rxd_sync) begin
+          rx_state_d = RxStart;
+          rx_cnt_d   = clk_div_q >> 1; // sample in the middle of each bit
+        end
+      end
+      RxStart: begin
+        if (rx_cnt_q == '0) begin
+          rx_state_d = rxd_sync ? RxIdle : RxData; // ignore glitches
+          rx_cnt_d   = clk_div_q - 1;
+          rx_bit_d   = '0;
+        end
+      end
+      RxData: begin
+        if (rx_cnt_q == '0) begin
+          rx_shift_d = {rxd_sync, rx_shift_q[7:1]};
+          rx_cnt_d   = clk_div_q - 1;
+          rx_bit_d   = rx_bit_q + 1;
+          if (rx_bit_q == 3'd7) rx_state_d = RxStop;
+        end
+      end
+      RxStop: begin
+        if (rx_cnt_q == '0) begin
+          rx_valid   = rxd_sync; // drop bytes with a framing error
+          rx_state_d = RxIdle;
+        end
+      end
+      default: rx_state_d = RxIdle;
+    endcase
+  end
+
+  `FF(rx_state_q, rx_state_d, RxIdle, clk_i, rst_ni)
+  `FF(rx_cnt_q,   rx_cnt_d,   '0,     clk_i, rst_ni)
+  `FF(rx_bit_q,   rx_bit_d,   '0,     clk_i, rst_ni)
+  `FF(rx_shift_q, rx_shift_d, '0,     clk_i, rst_ni)
+
+  // buffer received bytes while the loader is busy on the bus or transmitting
+  logic       rx_fifo_empty, rx_fifo_full, rx_fifo_pop;
+  logic [7:0] rx_byte;
+  logic       rx_ovf_q, rx_ovf_d; // a byte was dropped, the current frame is rejected
+
+  fifo_v3 #(
+    .DATA_WIDTH ( 8           ),
+    .DEPTH      ( RxFifoDepth )
+  ) i_rx_fifo (
+    .clk_i,
+    .rst_ni,
+    .flush_i    ( 1'b0                                ),
+    .testmode_i,
+    .full_o     ( rx_fifo_full                        ),
+    .empty_o    ( rx_fifo_empty                       ),
+    .usage_o    ( ),
+    .data_i     ( rx_shift_q                          ),
+    .push_i     ( rx_valid & active_o & ~rx_fifo_full ),
+    .data_o     ( rx_byte                             ),
+    .pop_i      ( rx_fifo_pop                         )
+  );
+
+
+  //-----------------------------------------------------------------------------------------------
+  // Transmitter
+  //-----------------------------------------------------------------------------------------------
+  logic [ 9:0] tx_shift_q, tx_shift_d; // {stop, data, start}, idles high
+  logic [ 3:0] tx_bits_q, tx_bits_d;   // bits left to send
+  logic [15:0] tx_cnt_q, tx_cnt_d;
+  logic        tx_valid, tx_ready;
+  logic [ 7:0] tx_data;
+
+  assign tx_ready = (tx_bits_q == '0);
+  assign txd_o    = tx_shift_q[0];
+
+  always_comb begin
+    tx_shift_d = tx_shift_q;
+    tx_bits_d  = tx_bits_q;
+    tx_cnt_d   = tx_cnt_q;
+
+    if (tx_valid && tx_ready) begin
+      tx_shift_d = {1'b1, tx_data, 1'b0};
+      tx_bits_d  = 4'd10;
+      tx_cnt_d   = clk_div_q - 1;
+    end else if (!tx_ready) begin
+      tx_cnt_d = tx_cnt_q - 1;
+      if (tx_cnt_q == '0) begin
+        tx_shift_d = {1'b1, tx_shift_q[9:1]};
+        tx_bits_d  = tx_bits_q - 1;
+        tx_cnt_d   = clk_div_q - 1;
+      end
+    end
+  end
+
+  `FF(tx_shift_q, tx_shift_d, '1, clk_i, rst_ni)
+  `FF(tx_bits_q,  tx_bits_d,  '0, clk_i, rst_ni)
+  `FF(tx_cnt_q,   tx_cnt_d,   '0, clk_i, rst_ni)
+
+
+  //-----------------------------------------------------------------------------------------------
+  // Command Handling
+  //-----------------------------------------------------------------------------------------------
+  typedef enum logic [3:0] {
+    Idle,       // wait for a command byte
+    RecvHeader, // address and length
+    RecvHdrCrc, // header checksum, then execute the command or receive the payload
+    RecvData,   // write payload, stored word by word
+    RecvCrc,    // payload checksum
+    Drain,      // frame length unknown: drop bytes until the line is idle, then reject
+    BusReq,     // OBI request phase
+    BusRsp,     // OBI response phase
+    SendByte,   // send send_cnt bytes from send_word
+    WaitTx,     // wait until the last byte left the transmitter
+    ReadNext,   // read command: fetch the next word or finish with the CRC
+    ReadSend,   // read command: send the fetched word
+    ExecFetch,  // exec command: enable instruction fetch
+    SetBaud,    // baud command: switch to the new clock divider
+    Done        // core is running, the loader is retired
+  } state_e;
+
+  state_e state_q, state_d;
+  state_e ret_q, ret_d;   // state to return to after bus access, send or wait
+
+  logic [ 7:0] cmd_q, cmd_d;
+  logic [31:0] addr_q, addr_d;
+  logic [31:0] len_q, len_d;
+  logic [31:0] word_q, word_d;   // assembled from/split into bytes
+  logic [ 2:0] cnt_q, cnt_d;     // byte counter within header/word/CRC
+  logic [31:0] crc_q, crc_d;
+  logic        err_q, err_d;     // bus or format error in the current frame
+
+  logic [31:0] bus_addr_q, bus_addr_d;
+  logic        bus_we_q, bus_we_d;
+
+  logic [31:0] send_word_q, send_word_d;
+  logic [ 2:0] send_cnt_q, send_cnt_d;
+  logic        send_crc_q, send_crc_d; // include sent bytes in the CRC
+
+  logic [TimeoutWidth-1:0] timeout_q, timeout_d;
+
+  logic [31:0] rx_word; // current word with the popped byte shifted in
+  assign rx_word = {rx_byte, word_q[31:8]};
+
+  assign active_o = enable_i & (state_q != Done);
+
+  always_comb begin
+    state_d     = state_q;
+    ret_d       = ret_q;
+    cmd_d       = cmd_q;
+    addr_d      = addr_q;
+    len_d       = len_q;
+    word_d      = word_q;
+    cnt_d       = cnt_q;
+    crc_d       = crc_q;
+    err_d       = err_q;
+    bus_addr_d  = bus_addr_q;
+    bus_we_d    = bus_we_q;
+    send_word_d = send_word_q;
+    send_cnt_d  = send_cnt_q;
+    send_crc_d  = send_crc_q;
+    clk_div_d   = clk_div_q;
+    timeout_d   = '0;
+    rx_ovf_d    = rx_ovf_q | (rx_valid & active_o & rx_fifo_full);
+
+    rx_fifo_pop = 1'b0;
+    tx_valid    = 1'b0;
+    tx_data     = send_word_q[7:0];
+
+    obi_req_o         = '0;
+    obi_req_o.a.addr  = bus_addr_q;
+    obi_req_o.a.we    = bus_we_q;
+    obi_req_o.a.be    = '1;
+    obi_req_o.a.wdata = word_q;
+
+    unique case (state_q)
+      Idle: begin
+        if (active_o && !rx_fifo_empty) begin
+          rx_fifo_pop = 1'b1;
+          cmd_d       = rx_byte;
+          crc_d       = crc32_byte(CrcInit, rx_byte);
+          err_d       = 1'b0;
+          cnt_d       = '0;
+          if (rx_byte inside {CmdRead, CmdWrite, CmdExec, CmdBaud}) begin
+            state_d = RecvHeader;
+          end else begin
+            // unknown command, the frame length is unknown so reject once the line is idle
+            state_d = Drain;
+          end
+        end
+      end
+
+      RecvHeader: begin
+        if (!rx_fifo_empty) begin
+          rx_fifo_pop = 1'b1;
+          crc_d       = crc32_byte(crc_q, rx_byte);
+          word_d      = rx_word;
+          cnt_d       = cnt_q + 1;
+          if (cnt_q == 3'd3) addr_d = rx_word;
+          if (cnt_q == 3'd7) begin
+            len_d = rx_word;
+            cnt_d = '0;
+            if (cmd_q inside {CmdRead, CmdWrite}) begin
+              err_d = (addr_q[1:0] != '0) || (rx_word[1:0] != '0);
+            end else begin
+              err_d = (rx_word != '0);
+            end
+            state_d = RecvHdrCrc;
+          end
+        end
+      end
+
+      RecvHdrCrc: begin
+        if (!rx_fifo_empty) begin
+          rx_fifo_pop = 1'b1;
+          word_d      = rx_word;
+          cnt_d       = cnt_q + 1;
+          if (cnt_q == 3'd3) begin
+            cnt_d       = '0;
+            send_word_d = {24'h0, RspAck};
+            send_cnt_d  = 3'd1;
+            send_crc_d  = 1'b0;
+            ret_d       = Idle;
+            state_d     = SendByte;
+            if (rx_word != ~crc_q) begin
+              // address and length cannot be trusted, neither can the frame length
+              state_d = Drain;
+            end else if (cmd_q == CmdWrite && len_q != '0) begin
+              // after a format error the payload is consumed without writing it
+              crc_d   = CrcInit; // payload CRC
+              state_d = RecvData;
+            end else if (err_q) begin
+              send_word_d = {24'h0, RspNak};
+            end else begin
+              unique case (cmd_q)
+                CmdRead: begin
+                  crc_d = CrcInit; // response CRC covers the read data
+                  ret_d = ReadNext;
+                end
+                CmdExec: begin
+                  // set the boot address before acknowledging
+                  bus_addr_d = BootAddrReg;
+                  bus_we_d   = 1'b1;
+                  word_d     = addr_q;
+                  ret_d      = SendByte;
+                  state_d    = BusReq;
+                end
+                CmdBaud: begin
+                  if (addr_q[15:0] < MinClkDiv || addr_q[31:16] != '0) begin
+                    send_word_d = {24'h0, RspNak};
+                  end else begin
+                    ret_d = WaitTx;
+                  end
+                end
+                default: ; // write without payload
+              endcase
+            end
+          end
+        end
+      end
+
+      RecvData: begin
+        if (!rx_fifo_empty) begin
+          rx_fifo_pop = 1'b1;
+          crc_d       = crc32_byte(crc_q, rx_byte);
+          word_d      = rx_word;
+          len_d       = len_q - 1;
+          cnt_d       = (cnt_q == 3'd3) ? '0 : cnt_q + 1;
+          ret_d       = (len_q == 32'd1) ? RecvCrc : RecvData;
+          if (len_q == 32'd1) begin
+            cnt_d   = '0;
+            state_d = RecvCrc;
+          end
+          // write complete words, the payload is still consumed after an error
+          if (cnt_q == 3'd3 && !err_q) begin
+            bus_addr_d = addr_q;
+            bus_we_d   = 1'b1;
+            addr_d     = addr_q + 4;
+            state_d    = BusReq;
+          end
+        end
+      end
+
+      RecvCrc: begin
+        if (!rx_fifo_empty) begin
+          rx_fifo_pop = 1'b1;
+          word_d      = rx_word;
+          cnt_d       = cnt_q + 1;
+          if (cnt_q == 3'd3) begin
+            // the payload is already in memory, a rejected frame is written again by the host
+            send_word_d = (rx_word != ~crc_q || err_q) ? {24'h0, RspNak} : {24'h0, RspAck};
+            send_cnt_d  = 3'd1;
+            send_crc_d  = 1'b0;
+            ret_d       = Idle;
+            state_d     = SendByte;
+          end
+        end
+      end
+
+      Drain: begin
+        rx_fifo_pop = !rx_fifo_empty; // rejected by the timeout below
+      end
+
+      BusReq: begin
+        obi_req_o.req = 1'b1;
+        if (obi_rsp_i.gnt) state_d = BusRsp;
+      end
+
+      BusRsp: begin
+        if (obi_rsp_i.rvalid) begin
+          err_d   = err_q | obi_rsp_i.r.err;
+          state_d = ret_q;
+          if (!bus_we_q) word_d = obi_rsp_i.r.rdata;
+          // exec: a failed boot address write turns the acknowledge into a rejection
+          if (cmd_q == CmdExec && ret_q == SendByte) begin
+            if (obi_rsp_i.r.err) begin
+              send_word_d = {24'h0, RspNak};
+              ret_d       = Idle;
+            end else begin
+              ret_d       = WaitTx;
+            end
+          end
+        end
+      end
+
+      SendByte: begin
+        tx_valid = 1'b1;
+        if (tx_ready) begin
+          send_word_d = send_word_q >> 8;
+          send_cnt_d  = send_cnt_q - 1;
+          if (send_crc_q) crc_d = crc32_byte(crc_q, send_word_q[7:0]);
+          if (send_cnt_q == 3'd1) state_d = ret_q;
+        end
+      end
+
+      WaitTx: begin
+        // wait for the acknowledge to leave before changing the baud rate or handing over
+        if (tx_ready) begin
+          unique case (cmd_q)
+            CmdExec: state_d = ExecFetch;
+            CmdBaud: state_d = SetBaud;
+            default: state_d = Idle;
+          endcase
+        end
+      end
+
+      ReadNext: begin
+        if (len_q == '0) begin
+          // a bus error during the read is reported by omitting the final CRC inversion
+          send_word_d = err_q ? crc_q : ~crc_q;
+          send_cnt_d  = 3'd4;
+          send_crc_d  = 1'b0;
+          ret_d       = Idle;
+          state_d     = SendByte;
+        end else begin
+          bus_addr_d = addr_q;
+          bus_we_d   = 1'b0;
+          addr_d     = addr_q + 4;
+          len_d      = len_q - 4;
+          ret_d      = ReadSend;
+          state_d    = BusReq;
+        end
+      end
+
+      ReadSend: begin
+        send_word_d = word_q;
+        send_cnt_d  = 3'd4;
+        send_crc_d  = 1'b1;
+        ret_d       = ReadNext;
+        state_d     = SendByte;
+      end
+
+      ExecFetch: begin
+        bus_addr_d = FetchEnReg;
+        bus_we_d   = 1'b1;
+        word_d     = 32'h1;
+        ret_d      = Done;
+        state_d    = BusReq;
+      end
+
+      SetBaud: begin
+        clk_div_d = addr_q[15:0];
+        state_d   = Idle;
+      end
+
+      Done: ;
+
+      default: state_d = Idle;
+    endcase
+
+    // drop a partial frame if the host stops sending (lost bytes), it will retry
+    if (state_q inside {RecvHeader, RecvHdrCrc, RecvData, RecvCrc, Drain} && rx_fifo_empty) begin
+      timeout_d = timeout_q + 1;
+      if (timeout_q == {clk_div_q, {$clog2(TimeoutBits){1'b0}}}) begin
+        state_d = Idle;
+        if (state_q == Drain) begin
+          rx_ovf_d    = 1'b0;
+          send_word_d = {24'h0, RspNak};
+          send_cnt_d  = 3'd1;
+          send_crc_d  = 1'b0;
+          ret_d       = Idle;
+          state_d     = SendByte;
+        end
+      end
+    end
+
+    // a dropped byte shifts the rest of the frame, its length cannot be trusted anymore
+    if (rx_ovf_q && state_q inside {Idle, RecvHeader, RecvHdrCrc, RecvData, RecvCrc}) begin
+      state_d = Drain;
+    end
+
+    // core was started by other means (JTAG, fetch enable pin), never touch the bus again
+    if (fetch_en_i && !(state_q inside {BusReq, BusRsp})) state_d = Done;
+  end
+
+  `FF(state_q,     state_d,     Idle,          clk_i, rst_ni)
+  `FF(ret_q,       ret_d,       Idle,          clk_i, rst_ni)
+  `FF(cmd_q,       cmd_d,       '0,            clk_i, rst_ni)
+  `FF(addr_q,      addr_d,      '0,            clk_i, rst_ni)
+  `FF(len_q,       len_d,       '0,            clk_i, rst_ni)
+  `FF(word_q,      word_d,      '0,            clk_i, rst_ni)
+  `FF(cnt_q,       cnt_d,       '0,            clk_i, rst_ni)
+  `FF(crc_q,       crc_d,       CrcInit,       clk_i, rst_ni)
+  `FF(err_q,       err_d,       '0,            clk_i, rst_ni)
+  `FF(bus_addr_q,  bus_addr_d,  '0,            clk_i, rst_ni)
+  `FF(bus_we_q,    bus_we_d,    '0,            clk_i, rst_ni)
+  `FF(send_word_q, send_word_d, '0,            clk_i, rst_ni)
+  `FF(send_cnt_q,  send_cnt_d,  '0,            clk_i, rst_ni)
+  `FF(send_crc_q,  send_crc_d,  '0,            clk_i, rst_ni)
+  `FF(timeout_q,   timeout_d,   '0,            clk_i, rst_ni)
+  `FF(clk_div_q,   clk_div_d,   DefaultClkDiv, clk_i, rst_ni)
+  `FF(rx_ovf_q,    rx_ovf_d,    1'b0,          clk_i, rst_ni)
+
+endmodule
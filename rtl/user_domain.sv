@@ -6,7 +6,8 @@
 // - Philippe Sauter <phsauter@iis.ee.ethz.ch>
 
 module user_domain import user_pkg::*; import croc_pkg::*; #(
-  parameter int unsigned GpioCount = 16
+  parameter int unsigned GpioCount        = 16,
+  parameter bit          UserSimMemEnable = 1'b0  // simulation-only memory, see user_domain/user_sim_mem.sv
 ) (
   input  logic      clk_i,
   input  logic      ref_clk_i,
@@ -25,6 +26,14 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
 
   assign interrupts_o = '0;  
 
+  // The simulation memory is only added to the demux when enabled, after the user subordinates
+  localparam int unsigned NumSbrRules = NumDemuxSbrRules + UserSimMemEnable;
+  localparam int unsigned NumSbr      = NumDemuxSbr + UserSimMemEnable;
+  localparam int unsigned SimMemIdx   = NumDemuxSbr;
+
+  localparam bit [31:0] SimMemAddrOffset = UserBaseAddr + 32'h0000_1000; // 32'h2000_1000, after the user ROM
+  localparam bit [31:0] SimMemAddrRange  = 32'h0000_1000;
+
 
   //////////////////////
   // User Manager MUX //
@@ -43,8 +52,8 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   // ----------------------------------------------------------------------------------------------
   
   // collection of signals from the demultiplexer
-  sbr_obi_req_t [NumDemuxSbr-1:0] all_user_sbr_obi_req;
-  sbr_obi_rsp_t [NumDemuxSbr-1:0] all_user_sbr_obi_rsp;
+  sbr_obi_req_t [NumSbr-1:0] all_user_sbr_obi_req;
+  sbr_obi_rsp_t [NumSbr-1:0] all_user_sbr_obi_rsp;
 
   // Error Subordinate Bus
   sbr_obi_req_t user_error_obi_req;
@@ -59,17 +68,32 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   // Demultiplex to User Subordinates according to address map
   //-----------------------------------------------------------------------------------------------
 
-  logic [cf_math_pkg::idx_width(NumDemuxSbr)-1:0] user_idx;
+  logic [cf_math_pkg::idx_width(NumSbr)-1:0] user_idx;
+
+  addr_map_rule_t [NumSbrRules-1:0] all_user_addr_map;
+
+  if (NumSbrRules > 0) begin : gen_addr_map
+    for (genvar i = 0; i < NumDemuxSbrRules; i++) begin : gen_user_rules
+      assign all_user_addr_map[i] = user_addr_map[i];
+    end
+    if (UserSimMemEnable) begin : gen_sim_mem_rule
+      assign all_user_addr_map[NumSbrRules-1] = '{ idx:        SimMemIdx,
+                                                   start_addr: SimMemAddrOffset,
+                                                   end_addr:   SimMemAddrOffset + SimMemAddrRange };
+    end
+  end else begin : gen_no_addr_map
+    assign all_user_addr_map = '0;
+  end
 
   addr_decode #(
-    .NoIndices ( NumDemuxSbr                    ),
-    .NoRules   ( NumDemuxSbrRules               ),
+    .NoIndices ( NumSbr                         ),
+    .NoRules   ( NumSbrRules                    ),
     .addr_t    ( logic[SbrObiCfg.DataWidth-1:0] ),
     .rule_t    ( addr_map_rule_t                ),
     .Napot     ( 1'b0                           )
   ) i_addr_decode_periphs (
     .addr_i           ( user_sbr_obi_req_i.a.addr ),
-    .addr_map_i       ( user_addr_map             ),
+    .addr_map_i       ( all_user_addr_map         ),
     .idx_o            ( user_idx                  ),
     .dec_valid_o      (),
     .dec_error_o      (),
@@ -81,7 +105,7 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
     .ObiCfg      ( SbrObiCfg     ),
     .obi_req_t   ( sbr_obi_req_t ),
     .obi_rsp_t   ( sbr_obi_rsp_t ),
-    .NumMgrPorts ( NumDemuxSbr   ),
+    .NumMgrPorts ( NumSbr        ),
     .NumMaxTrans ( 2             )
   ) i_obi_demux (
     .clk_i,
@@ -115,4 +139,20 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
     .obi_rsp_o  ( user_error_obi_rsp )
   );
 
+  // Simulation Memory Subordinate
+  if (UserSimMemEnable) begin : gen_sim_mem
+    user_sim_mem #(
+      .ObiCfg    ( SbrObiCfg           ),
+      .obi_req_t ( sbr_obi_req_t       ),
+      .obi_rsp_t ( sbr_obi_rsp_t       ),
+      .NumWords  ( SimMemAddrRange / 4 ),
+      .Latency   ( 4                   )
+    ) i_user_sim_mem (
+      .clk_i,
+      .rst_ni,
+      .obi_req_i ( all_user_sbr_obi_req[SimMemIdx] ),
+      .obi_rsp_o ( all_user_sbr_obi_rsp[SimMemIdx] )
+    );
+  end
+
 endmodule
@@ -0,0 +1,87 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+`include "common_cells/registers.svh"
+
+/// Simulation-only memory modelling slow external memory (e.g. a QSPI flash/RAM).
+/// Handles one access at a time and answers `Latency` cycles after the grant.
+/// Used by the testbench to execute code in place from the user domain; not meant for synthesis.
+module user_sim_mem #(
+  /// The OBI configuration of the subordinate port.
+  parameter obi_pkg::obi_cfg_t ObiCfg = obi_pkg::ObiDefaultConfig,
+  /// OBI request type
+  parameter type obi_req_t            = logic,
+  /// OBI response type
+  parameter type obi_rsp_t            = logic,
+  /// Number of 32 bit words, a power of two.
+  parameter int unsigned NumWords     = 1024,
+  /// Cycles from the grant to the response (at least 1).
+  parameter int unsigned Latency      = 4
+) (
+  /// Primary input clock
+  input  logic     clk_i,
+  /// Asynchronous active-low reset
+  input  logic     rst_ni,
+
+  /// Subordinate port from the interconnect (request).
+  input  obi_req_t obi_req_i,
+  /// Subordinate port back into the interconnect (response).
+  output obi_rsp_t obi_rsp_o
+);
+
+  localparam int unsigned AddrWidth = $clog2(NumWords);
+
+  logic [ObiCfg.DataWidth-1:0] mem [NumWords];
+
+  logic                        busy_q, busy_d;
+  logic [$clog2(Latency+1)-1:0] cnt_q, cnt_d;
+  logic [ObiCfg.DataWidth-1:0] rdata_q, rdata_d;
+  logic [ObiCfg.IdWidth-1:0]   rid_q, rid_d;
+  logic [AddrWidth-1:0]        word_addr;
+  logic                        gnt;
+
+  assign word_addr = obi_req_i.a.addr[2 +: AddrWidth];
+  assign gnt       = obi_req_i.req & ~busy_q;
+
+  always_comb begin
+    busy_d  = busy_q;
+    cnt_d   = cnt_q;
+    rdata_d = rdata_q;
+    rid_d   = rid_q;
+
+    if (busy_q) begin
+      cnt_d = cnt_q - 1;
+      if (cnt_q == '0) busy_d = 1'b0;
+    end
+
+    if (gnt) begin
+      busy_d  = 1'b1;
+      cnt_d   = Latency - 1;
+      rdata_d = mem[word_addr];
+      rid_d   = obi_req_i.a.aid;
+    end
+  end
+
+  always_ff @(posedge clk_i) begin
+    if (gnt && obi_req_i.a.we) begin
+      for (int unsigned i = 0; i < ObiCfg.DataWidth/8; i++) begin
+        if (obi_req_i.a.be[i]) mem[word_addr][8*i +: 8] <= obi_req_i.a.wdata[8*i +: 8];
+      end
+    end
+  end
+
+  always_comb begin
+    obi_rsp_o         = '0;
+    obi_rsp_o.gnt     = gnt;
+    obi_rsp_o.rvalid  = busy_q & (cnt_q == '0);
+    obi_rsp_o.r.rdata = rdata_q;
+    obi_rsp_o.r.rid   = rid_q;
+  end
+
+  `FF(busy_q,  busy_d,  1'b0, clk_i, rst_ni)
+  `FF(cnt_q,   cnt_d,   '0,   clk_i, rst_ni)
+  `FF(rdata_q, rdata_d, '0,   clk_i, rst_ni)
+  `FF(rid_q,   rid_d,   '0,   clk_i, rst_ni)
+
+endmodule
@@ -12,6 +12,11 @@
 #define UART_BASE_ADDR    0x03002000
 #define GPIO_BASE_ADDR    0x03005000
 #define TIMER_BASE_ADDR   0x0300A000
+#define ICACHE_BASE_ADDR  0x0300B000
+
+// Simulation-only memory in the user domain (tb_croc_soc)
+#define USER_SIM_MEM_BASE_ADDR 0x20001000
+#define USER_SIM_MEM_SIZE      0x1000
 
 // Frequencies
 #define TB_FREQUENCY 20000000
@@ -0,0 +1,28 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include "config.h"
+
+// Register offsets
+#define ICACHE_CTRL_REG_OFFSET   0x0
+#define ICACHE_HITS_REG_OFFSET   0x4
+#define ICACHE_MISSES_REG_OFFSET 0x8
+
+// Register fields
+#define ICACHE_CTRL_ENABLE_BIT 0
+#define ICACHE_CTRL_FLUSH_BIT  1
+#define ICACHE_CTRL_CLEAR_BIT  2
+
+void icache_enable(void);
+void icache_disable(void);
+// invalidate all lines (also done by fence.i)
+void icache_flush(void);
+
+// fetch counters (only fetches from the cached user-domain region are counted)
+uint32_t icache_hits(void);
+uint32_t icache_misses(void);
+void icache_clear_counters(void);
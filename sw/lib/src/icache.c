@@ -0,0 +1,33 @@
+// Copyright 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "icache.h"
+#include "util.h"
+#include "config.h"
+
+void icache_enable(void) {
+    *reg32(ICACHE_BASE_ADDR, ICACHE_CTRL_REG_OFFSET) = (1 << ICACHE_CTRL_ENABLE_BIT);
+}
+
+void icache_disable(void) {
+    *reg32(ICACHE_BASE_ADDR, ICACHE_CTRL_REG_OFFSET) = 0;
+}
+
+void icache_flush(void) {
+    *reg32(ICACHE_BASE_ADDR, ICACHE_CTRL_REG_OFFSET) |= (1 << ICACHE_CTRL_FLUSH_BIT);
+    // drop instructions already in the core's prefetch buffer
+    fencei();
+}
+
+uint32_t icache_hits(void) {
+    return *reg32(ICACHE_BASE_ADDR, ICACHE_HITS_REG_OFFSET);
+}
+
+uint32_t icache_misses(void) {
+    return *reg32(ICACHE_BASE_ADDR, ICACHE_MISSES_REG_OFFSET);
+}
+
+void icache_clear_counters(void) {
+    *reg32(ICACHE_BASE_ADDR, ICACHE_CTRL_REG_OFFSET) |= (1 << ICACHE_CTRL_CLEAR_BIT);
+}
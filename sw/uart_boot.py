@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Host-side loader for the Croc UART bootmode (see rtl/uart_boot/README.md).
+# Loads a binary (objcopy verilog hex as produced in sw/bin/) into memory and starts the core.
+#
+# Example:
+#   python3 uart_boot.py /dev/ttyUSB0 bin/helloworld.hex --baud 1000000 --verify
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+import serial  # pyserial
+
+CMD_READ  = 0x11
+CMD_WRITE = 0x12
+CMD_EXEC  = 0x13
+CMD_BAUD  = 0x16
+RSP_ACK   = 0x06
+RSP_NAK   = 0x15
+
+MIN_CLK_DIV = 4
+BOOT_BAUD   = 115200   # loader baud rate after reset
+RETRIES     = 3
+
+
+def read_hex(path):
+    """Parse an objcopy verilog hex file into a list of (address, bytes) segments."""
+    segments = []
+    addr = None
+    data = bytearray()
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            if line.startswith('@'):
+                new_addr = int(line[1:], 16)
+                if data and new_addr != addr + len(data):
+                    segments.append((addr, bytes(data)))
+                    data = bytearray()
+                if not data:
+                    addr = new_addr
+                continue
+            data += bytes(int(b, 16) for b in line.split())
+    if data:
+        segments.append((addr, bytes(data)))
+    return segments
+
+
+class UartBoot:
+    def __init__(self, port, clk_freq, timeout):
+        self.clk_freq = clk_freq
+        self.ser = serial.Serial(port, baudrate=round(clk_freq / round(clk_freq / BOOT_BAUD)),
+                                 timeout=timeout)
+
+    def _frame(self, cmd, addr, payload=b'', length=None):
+        length = len(payload) if length is None else length
+        header = struct.pack('<BII', cmd, addr, length)
+        frame = header + struct.pack('<I', zlib.crc32(header))
+        if payload:
+            frame += payload + struct.pack('<I', zlib.crc32(payload))
+        return frame
+
+    def _command(self, cmd, addr, payload=b'', length=None):
+        frame = self._frame(cmd, addr, payload, length)
+        # 10 bits per byte (start, 8 data, stop)
+        frame_time = len(frame) * 10 / self.ser.baudrate
+        for _ in range(RETRIES):
+            self.ser.reset_input_buffer()
+            self.ser.write(frame)
+            self.ser.flush()
+            rsp = self.ser.read(1)
+            if rsp == bytes([RSP_ACK]):
+                return
+            # an early NAK can arrive while the frame is still on the wire (USB adapter buffers),
+            # wait for the rest of it and for the loader to drop it (64 bit periods) before retrying
+            time.sleep(0.01 + frame_time + 64 / self.ser.baudrate)
+        raise RuntimeError(f'command 0x{cmd:02x} @ 0x{addr:08x} failed (response: {rsp!r})')
+
+    def set_baud(self, baud):
+        clk_div = round(self.clk_freq / baud)
+        if clk_div < MIN_CLK_DIV or clk_div > 0xFFFF:
+            raise ValueError(f'baud rate {baud} not reachable with a {self.clk_freq} Hz clock')
+        self._command(CMD_BAUD, clk_div)
+        # the loader switches after its acknowledge is sent
+        time.sleep(0.001)
+        self.ser.baudrate = round(self.clk_freq / clk_div)
+        return self.ser.baudrate
+
+    def write(self, addr, data, block_size):
+        data = data + bytes(-len(data) % 4)
+        for offs in range(0, len(data), block_size):
+            self._command(CMD_WRITE, addr + offs, data[offs:offs + block_size])
+
+    def read(self, addr, length, block_size):
+        data = bytearray()
+        for offs in range(0, length, block_size):
+            size = min(block_size, length - offs)
+            self._command(CMD_READ, addr + offs, length=size)
+            block = self.ser.read(size)
+            crc = self.ser.read(4)
+            if len(block) != size or len(crc) != 4 or struct.unpack('<I', crc)[0] != zlib.crc32(block):
+                # the loader corrupts the CRC if the read saw a bus error
+                raise RuntimeError(f'read @ 0x{addr + offs:08x} failed')
+            data += block
+        return bytes(data)
+
+    def exec(self, boot_addr):
+        self._command(CMD_EXEC, boot_addr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Load a binary via the Croc UART bootmode')
+    parser.add_argument('port', help='serial port, e.g. /dev/ttyUSB0')
+    parser.add_argument('hex', help='objcopy verilog hex file (sw/bin/*.hex)')
+    parser.add_argument('--clk-freq', type=float, default=20e6, help='SoC clock frequency in Hz')
+    parser.add_argument('--baud', type=int, default=1000000, help='baud rate used for loading')
+    parser.add_argument('--block-size', type=int, default=1024, help='payload bytes per frame')
+    parser.add_argument('--boot-addr', type=lambda x: int(x, 0), default=0x10000000,
+                        help='address the core starts at')
+    parser.add_argument('--verify', action='store_true', help='read back memory before booting')
+    parser.add_argument('--no-exec', action='store_true', help='load only, do not start the core')
+    args = parser.parse_args()
+
+    if args.block_size % 4:
+        parser.error('block size must be a multiple of 4')
+
+    segments = read_hex(args.hex)
+    boot = UartBoot(args.port, args.clk_freq, timeout=1.0)
+    print(f'Loader at {boot.set_baud(args.baud)} baud')
+
+    start = time.time()
+    total = 0
+    for addr, data in segments:
+        print(f'Writing {len(data)} bytes to 0x{addr:08x}')
+        boot.write(addr, data, args.block_size)
+        total += len(data)
+    duration = time.time() - start
+    print(f'Loaded {total} bytes in {duration:.3f}s ({total / 1024 / duration:.1f} KiB/s)')
+
+    if args.verify:
+        for addr, data in segments:
+            if boot.read(addr, len(data) + (-len(data) % 4), args.block_size)[:len(data)] != data:
+                sys.exit(f'Verification of 0x{addr:08x} failed')
+        print('Verification passed')
+
+    if not args.no_exec:
+        boot.exec(args.boot_addr)
+        print(f'Core started at 0x{args.boot_addr:08x}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,124 @@
+// Copyright (c) 2025 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Executes code in place from the user-domain simulation memory through the instruction cache.
+// Needs tb_croc_soc with ICacheEnable and UserSimMemEnable set:
+//   make verilator SW_HEX=sw/bin/xip.hex TB_PARAMS="-GICacheEnable=1 -GUserSimMemEnable=1"
+
+#include "uart.h"
+#include "print.h"
+#include "icache.h"
+#include "util.h"
+#include "config.h"
+
+// Functions in .xip are copied to the simulation memory and run from there.
+// They must be position independent: no calls, no globals and no constants from memory.
+#define XIP_FUNC __attribute__((section(".xip"), noinline))
+
+// from link.ld
+extern uint32_t __xip_start[], __xip_end[];
+
+// the generated function is placed after the copied .xip code
+#define GEN_FUNC_OFFSET 0x800
+
+#define CHECKSUM_ITERATIONS 64
+
+XIP_FUNC uint32_t xip_checksum(uint32_t n) {
+    uint32_t x = 0x1234567;
+    for (uint32_t i = 0; i < n; i++) {
+        x = (x << 5) ^ (x >> 3) ^ i;
+    }
+    return x;
+}
+
+// address of an .xip function in the simulation memory
+static void *xip_addr(void *fn) {
+    return (void *)(USER_SIM_MEM_BASE_ADDR + ((uint32_t)fn - (uint32_t)__xip_start));
+}
+
+// write `li a0, imm; ret` to the simulation memory
+static void gen_return_const(uint32_t imm) {
+    *reg32(USER_SIM_MEM_BASE_ADDR, GEN_FUNC_OFFSET)     = (imm << 20) | 0x00000513; // addi a0, zero, imm
+    *reg32(USER_SIM_MEM_BASE_ADDR, GEN_FUNC_OFFSET + 4) = 0x00008067;               // jalr zero, 0(ra)
+}
+
+// returns 2 on failure so the exit code differs from a passing run
+static int check(int cond, char *msg) {
+    if (cond) return 0;
+    printf("XIP test failed: ");
+    printf(msg);
+    uart_write_flush();
+    return 2;
+}
+
+int main() {
+    uart_init();
+    printf("XIP test\n");
+    uart_write_flush();
+
+    uint32_t (*checksum_fn)(uint32_t) = xip_addr(xip_checksum);
+    uint32_t (*gen_fn)(void)          = (void *)(USER_SIM_MEM_BASE_ADDR + GEN_FUNC_OFFSET);
+    uint32_t start, sram_cycles, cold_cycles, warm_cycles;
+    uint32_t sram_res, cold_res, warm_res, hits, misses;
+
+    // copy the code into the simulation memory
+    for (uint32_t *src = __xip_start, *dst = (uint32_t *)USER_SIM_MEM_BASE_ADDR; src < __xip_end;) {
+        *dst++ = *src++;
+    }
+    fencei();
+
+    // reference run from SRAM
+    start       = get_mcycle();
+    sram_res    = xip_checksum(CHECKSUM_ITERATIONS);
+    sram_cycles = get_mcycle() - start;
+
+    // first run from the simulation memory refills the lines, the second one only hits
+    icache_clear_counters();
+    start       = get_mcycle();
+    cold_res    = checksum_fn(CHECKSUM_ITERATIONS);
+    cold_cycles = get_mcycle() - start;
+    misses      = icache_misses();
+    hits        = icache_hits();
+
+    start       = get_mcycle();
+    warm_res    = checksum_fn(CHECKSUM_ITERATIONS);
+    warm_cycles = get_mcycle() - start;
+
+    printf("Result: 0x%x, Cycles SRAM: 0x%x, cold: 0x%x, warm: 0x%x\n",
+           sram_res, sram_cycles, cold_cycles, warm_cycles);
+    printf("Hits: 0x%x, Misses: 0x%x\n", icache_hits(), icache_misses());
+    uart_write_flush();
+
+    CHECK_CALL(check(cold_res == sram_res && warm_res == sram_res, "wrong result\n"))
+    CHECK_CALL(check(misses != 0, "no misses on cold run\n"))
+    CHECK_CALL(check(icache_misses() == misses, "misses on warm run\n"))
+    CHECK_CALL(check(icache_hits() > hits, "no hits on warm run\n"))
+    CHECK_CALL(check(warm_cycles < cold_cycles, "warm run not faster\n"))
+
+    // modified code is only seen after invalidation
+    gen_return_const(1);
+    fencei();
+    CHECK_CALL(check(gen_fn() == 1, "generated code\n"))
+
+    gen_return_const(2);
+    CHECK_CALL(check(gen_fn() == 1, "modified code seen without invalidation\n"))
+    fencei();
+    CHECK_CALL(check(gen_fn() == 2, "stale code after fence.i\n"))
+
+    // only FLUSH, no fence.i (the call drops the core's prefetched instructions)
+    gen_return_const(3);
+    *reg32(ICACHE_BASE_ADDR, ICACHE_CTRL_REG_OFFSET) =
+        (1 << ICACHE_CTRL_ENABLE_BIT) | (1 << ICACHE_CTRL_FLUSH_BIT);
+    CHECK_CALL(check(gen_fn() == 3, "stale code after FLUSH\n"))
+
+    // fetches bypass a disabled cache
+    icache_disable();
+    gen_return_const(4);
+    CHECK_CALL(check(gen_fn() == 4, "stale code with cache disabled\n"))
+    icache_enable();
+
+    printf("XIP test passed\n");
+    uart_write_flush();
+    return 1;
+}
@@ -125,19 +125,21 @@ module croc_xilinx import croc_pkg::*; #(
   ////////////
   //  VIOs  //
   ////////////
-  logic       vio_reset, vio_fetch_en, vio_gpio;
+  logic       vio_reset, vio_fetch_en, vio_gpio, vio_bootmode;
 
 `ifdef USE_VIO
   vio i_vio (
     .clk        ( soc_clk      ),
     .probe_out0 ( vio_reset    ),
     .probe_out1 ( vio_fetch_en ),
-    .probe_out2 ( vio_gpio     )
+    .probe_out2 ( vio_gpio     ),
+    .probe_out3 ( vio_bootmode )
   );
 `else
   assign vio_reset    = '0;
   assign vio_fetch_en = '0;
   assign vio_gpio     = '0;
+  assign vio_bootmode = '0;
 `endif
 
 
@@ -252,6 +254,7 @@ module croc_xilinx import croc_pkg::*; #(
     .ref_clk_i       ( rtc_clk_q      ),
     .testmode_i      ( soc_testmode_i ),
     .fetch_en_i      ( soc_fetch_en   ),
+    .bootmode_i      ( vio_bootmode   ),
     .status_o        ( status_o       ),
 
     .jtag_tck_i      ( jtag_tck_i   ),